@@ -0,0 +1,194 @@
+#include <iostream>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+#include <unsupported/Eigen/FFT>
+#include <Eigen/Dense>
+
+#include <memory>
+#include <complex>
+#include <vector>
+
+// One engine per thread and scalar type; Eigen::FFT keeps the plans and twiddle factors
+// of every length it has seen, so repeated transforms of the same shape skip setup
+template<typename Real>
+Eigen::FFT<Real>& fft_engine() {
+  static thread_local Eigen::FFT<Real> engine(typename Eigen::FFT<Real>::impl_type(), Eigen::FFT<Real>::HalfSpectrum);
+  return engine;
+}
+
+template<size_t M>
+std::vector<int> fft_axes(const std::vector<int>& axes) {
+  std::vector<int> res = axes;
+  if (res.empty()) {
+    for (int i = 0; i < static_cast<int>(M); ++i) res.push_back(i);
+  }
+  for (size_t i = 0; i < res.size(); ++i) {
+    if (res[i] < 0 || res[i] >= static_cast<int>(M)) {
+      throw std::invalid_argument("Axis out of range");
+    }
+    if (std::find(res.begin(), res.begin() + i, res[i]) != res.begin() + i) {
+      throw std::invalid_argument("Axes to transform must be unique");
+    }
+  }
+  return res;
+}
+
+// Apply a 1D kernel to every line along one axis. Lines are copied in tiles of neighbouring
+// lines so the strided reads and writes touch whole cache lines, and tiles are spread across threads
+template<typename In, typename Out, typename Kernel>
+void transform_lines(const In* src, Out* dst, const AxisLayout& layout, Eigen::Index n_out, Kernel kernel) {
+  const Eigen::Index inner = layout.inner;
+  const Eigen::Index n_in = layout.extent;
+  if (inner * layout.outer * n_in == 0) return;
+  const Eigen::Index block = std::min<Eigen::Index>(inner, 8);
+  const Eigen::Index blocks = (inner + block - 1) / block;
+  const Eigen::Index work = layout.outer * blocks;
+  NDARRAY_OMP("omp parallel if(work * block * n_in > parallel_threshold)")
+  {
+    std::vector<In> tile_in(block * n_in);
+    std::vector<Out> tile_out(block * n_out);
+    NDARRAY_OMP("omp for schedule(static)")
+    for (Eigen::Index w = 0; w < work; ++w) {
+      Eigen::Index o = w / blocks;
+      Eigen::Index i0 = (w % blocks) * block;
+      Eigen::Index b = std::min(block, inner - i0);
+      const In* s = src + i0 + inner * n_in * o;
+      for (Eigen::Index k = 0; k < n_in; ++k) {
+        for (Eigen::Index l = 0; l < b; ++l) tile_in[l * n_in + k] = s[inner * k + l];
+      }
+      for (Eigen::Index l = 0; l < b; ++l) kernel(&tile_out[l * n_out], &tile_in[l * n_in]);
+      Out* d = dst + i0 + inner * n_out * o;
+      for (Eigen::Index k = 0; k < n_out; ++k) {
+        for (Eigen::Index l = 0; l < b; ++l) d[inner * k + l] = tile_out[l * n_out + k];
+      }
+    }
+  }
+}
+
+template<typename C, int M>
+void complex_fft_axes(Tensor<C, M>& data, const std::vector<int>& axes, bool inverse) {
+  using Real = typename C::value_type;
+  for (int axis : axes) {
+    AxisLayout layout = axis_layout<M>(data.dimensions(), axis);
+    Eigen::Index n = layout.extent;
+    transform_lines(data.data(), data.data(), layout, n, [n, inverse](C* dst, const C* src) {
+      if (inverse) {
+        fft_engine<Real>().inv(dst, src, n);
+      } else {
+        fft_engine<Real>().fwd(dst, src, n);
+      }
+    });
+  }
+}
+
+template<typename T, size_t M, size_t N>
+void Ndarray<T, M, N>::fft(Ndarray<ComplexScalar, M>& out, const std::vector<int>& axes) const {
+  std::vector<int> axes_ = fft_axes<M>(axes);
+  ensure_extents(out, indices.extents);
+  *out.base_array = get_array().template cast<ComplexScalar>();
+  complex_fft_axes(*out.base_array, axes_, false);
+}
+
+template<typename T, size_t M, size_t N>
+void Ndarray<T, M, N>::ifft(Ndarray<ComplexScalar, M>& out, const std::vector<int>& axes) const {
+  std::vector<int> axes_ = fft_axes<M>(axes);
+  ensure_extents(out, indices.extents);
+  *out.base_array = get_array().template cast<ComplexScalar>();
+  complex_fft_axes(*out.base_array, axes_, true);
+}
+
+// The last listed axis carries the real-to-complex transform and keeps n/2+1 bins
+template<typename T, size_t M, size_t N>
+void Ndarray<T, M, N>::rfft(Ndarray<ComplexScalar, M>& out, const std::vector<int>& axes) const {
+  static_assert(!Eigen::NumTraits<T>::IsComplex, "rfft requires a real-valued array");
+  std::vector<int> axes_ = fft_axes<M>(axes);
+  int real_axis = axes_.back();
+  axes_.pop_back();
+  AxisLayout layout = axis_layout<M>(indices.extents, real_axis);
+  Eigen::Index n = layout.extent;
+  if (n == 0) {
+    throw std::invalid_argument("Cannot take a real transform along an empty axis");
+  }
+  Eigen::array<Eigen::Index, M> out_dims = indices.extents;
+  out_dims[real_axis] = n / 2 + 1;
+  ensure_extents(out, out_dims);
+
+  Tensor<RealScalar, M> dense;
+  const RealScalar* src = reinterpret_cast<const RealScalar*>(base_array->data());
+  if (N != M || is_sliced || !std::is_same_v<T, RealScalar>) {
+    dense = get_array().template cast<RealScalar>();
+    src = dense.data();
+  }
+  transform_lines(src, out.base_array->data(), layout, n / 2 + 1, [n](ComplexScalar* dst, const RealScalar* line) {
+    fft_engine<RealScalar>().fwd(dst, line, n);
+  });
+  complex_fft_axes(*out.base_array, axes_, false);
+}
+
+// n is the length of the real output along the last listed axis, 2*(m-1) by default. The
+// complex inverse runs in scratch, which may be the spectrum itself when it can be overwritten
+template<typename T, size_t M, size_t N>
+void Ndarray<T, M, N>::irfft(Ndarray<RealScalar, M>& out, Ndarray<ComplexScalar, M>& scratch,
+                             const std::vector<int>& axes, Eigen::Index n) const {
+  std::vector<int> axes_ = fft_axes<M>(axes);
+  int real_axis = axes_.back();
+  axes_.pop_back();
+  Eigen::Index m = indices.extents[real_axis];
+  if (n < 0) n = 2 * (m - 1);
+  if (n < 1 || n / 2 + 1 != m) {
+    throw std::invalid_argument("Output length does not match the half spectrum along the last axis");
+  }
+  Eigen::array<Eigen::Index, M> out_dims = indices.extents;
+  out_dims[real_axis] = n;
+  ensure_extents(out, out_dims);
+  ensure_extents(scratch, indices.extents);
+
+  Tensor<ComplexScalar, M>& work = *scratch.base_array;
+  work = get_array().template cast<ComplexScalar>();
+  complex_fft_axes(work, axes_, true);
+  AxisLayout layout = axis_layout<M>(work.dimensions(), real_axis);
+  transform_lines(work.data(), out.base_array->data(), layout, n, [n](RealScalar* dst, const ComplexScalar* line) {
+    fft_engine<RealScalar>().inv(dst, line, n);
+  });
+}
+
+// Convenience overload: allocates its complex scratch, pass one explicitly to reuse it across calls
+template<typename T, size_t M, size_t N>
+void Ndarray<T, M, N>::irfft(Ndarray<RealScalar, M>& out, const std::vector<int>& axes, Eigen::Index n) const {
+  Ndarray<ComplexScalar, M> scratch(std::make_shared<Tensor<ComplexScalar, M>>(indices.extents));
+  irfft(out, scratch, axes, n);
+}
+
+template<typename T, size_t M, size_t N>
+Ndarray<typename Ndarray<T, M, N>::ComplexScalar, M> Ndarray<T, M, N>::fft(const std::vector<int>& axes) const {
+  Ndarray<ComplexScalar, M> res(std::make_shared<Tensor<ComplexScalar, M>>(indices.extents));
+  fft(res, axes);
+  return res;
+}
+
+template<typename T, size_t M, size_t N>
+Ndarray<typename Ndarray<T, M, N>::ComplexScalar, M> Ndarray<T, M, N>::ifft(const std::vector<int>& axes) const {
+  Ndarray<ComplexScalar, M> res(std::make_shared<Tensor<ComplexScalar, M>>(indices.extents));
+  ifft(res, axes);
+  return res;
+}
+
+template<typename T, size_t M, size_t N>
+Ndarray<typename Ndarray<T, M, N>::ComplexScalar, M> Ndarray<T, M, N>::rfft(const std::vector<int>& axes) const {
+  Eigen::array<Eigen::Index, M> dims = indices.extents;
+  int real_axis = fft_axes<M>(axes).back();
+  dims[real_axis] = dims[real_axis] / 2 + 1;
+  Ndarray<ComplexScalar, M> res(std::make_shared<Tensor<ComplexScalar, M>>(dims));
+  rfft(res, axes);
+  return res;
+}
+
+template<typename T, size_t M, size_t N>
+Ndarray<typename Ndarray<T, M, N>::RealScalar, M> Ndarray<T, M, N>::irfft(const std::vector<int>& axes, Eigen::Index n) const {
+  Eigen::array<Eigen::Index, M> dims = indices.extents;
+  int real_axis = fft_axes<M>(axes).back();
+  dims[real_axis] = n < 0 ? 2 * (dims[real_axis] - 1) : n;
+  Ndarray<RealScalar, M> res(std::make_shared<Tensor<RealScalar, M>>(dims));
+  irfft(res, axes, n);
+  return res;
+}
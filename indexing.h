@@ -0,0 +1,196 @@
+#include <iostream>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+#include <Eigen/Dense>
+
+#include <memory>
+#include <numeric>
+#include <algorithm>
+#include <vector>
+
+// Column-major view of a tensor as (inner, extent, outer) around one axis,
+// so every index along the axis addresses `outer` contiguous runs of `inner` elements
+struct AxisLayout {
+  Eigen::Index inner = 1;
+  Eigen::Index extent = 1;
+  Eigen::Index outer = 1;
+};
+
+template<size_t M>
+AxisLayout axis_layout(const Eigen::array<Eigen::Index, M>& dims, int axis) {
+  if (axis < 0 || axis >= static_cast<int>(M)) {
+    throw std::invalid_argument("Axis out of range");
+  }
+  AxisLayout layout;
+  for (int i = 0; i < axis; ++i) layout.inner *= dims[i];
+  layout.extent = dims[axis];
+  for (int i = axis + 1; i < static_cast<int>(M); ++i) layout.outer *= dims[i];
+  return layout;
+}
+
+template<typename I, size_t J>
+std::vector<Eigen::Index> read_indices(const Ndarray<I, 1, J>& indices, Eigen::Index extent) {
+  static_assert(std::is_integral_v<I>, "Index array must hold integral values");
+  Tensor<I, 1> flat = indices.get_array();
+  std::vector<Eigen::Index> idx(flat.data(), flat.data() + flat.size());
+  for (auto i : idx) {
+    if (i < 0 || i >= extent) {
+      throw std::out_of_range("Index out of range along axis");
+    }
+  }
+  return idx;
+}
+
+// Visiting order that walks the indexed axis monotonically; stable so duplicates keep their order
+inline std::vector<Eigen::Index> sorted_order(const std::vector<Eigen::Index>& idx) {
+  std::vector<Eigen::Index> order(idx.size());
+  std::iota(order.begin(), order.end(), 0);
+  if (!std::is_sorted(idx.begin(), idx.end())) {
+    std::stable_sort(order.begin(), order.end(), [&](Eigen::Index a, Eigen::Index b) { return idx[a] < idx[b]; });
+  }
+  return order;
+}
+
+// Base-array offsets of a (sliced or chipped) view around one axis: view position k along the axis
+// of outer block o starts at outer_offsets[o] + k * axis_stride, and its inner block is
+// stored as runs of `run` contiguous elements starting at run_offsets
+struct AxisStrides {
+  Eigen::Index run = 1;
+  Eigen::Index axis_stride = 1;
+  std::vector<Eigen::Index> run_offsets;
+  std::vector<Eigen::Index> outer_offsets;
+
+  Eigen::Index inner() const {
+    return run * run_offsets.size();
+  }
+};
+
+// Offsets of every point of the box spanned by dims [lo, hi), enumerated in column-major order
+template<size_t M>
+std::vector<Eigen::Index> box_offsets(const Eigen::array<Eigen::Index, M>& strides, const Eigen::array<Eigen::Index, M>& extents,
+                                      size_t lo, size_t hi, Eigen::Index start) {
+  std::vector<Eigen::Index> res{start};
+  for (size_t d = lo; d < hi; ++d) {
+    size_t count = res.size();
+    res.resize(count * extents[d]);
+    for (Eigen::Index c = 1; c < extents[d]; ++c) {
+      for (size_t k = 0; k < count; ++k) res[c * count + k] = res[k] + c * strides[d];
+    }
+  }
+  return res;
+}
+
+template<size_t M>
+AxisStrides axis_strides(const Eigen::array<Eigen::Index, M>& strides, const Eigen::array<Eigen::Index, M>& extents,
+                         Eigen::Index origin, int axis) {
+  axis_layout<M>(extents, axis);
+  // Leading dims merge into one contiguous run as long as each continues where the last ended
+  AxisStrides view;
+  size_t merged = 0;
+  if (strides[0] == 1) {
+    while (merged < static_cast<size_t>(axis)) {
+      view.run *= extents[merged];
+      ++merged;
+      if (merged < static_cast<size_t>(axis) && strides[merged] != view.run) break;
+    }
+  }
+  view.axis_stride = strides[axis];
+  view.run_offsets = box_offsets<M>(strides, extents, merged, axis, 0);
+  view.outer_offsets = box_offsets<M>(strides, extents, axis + 1, M, origin);
+  return view;
+}
+
+// Gather into a dense result whose inner blocks are contiguous
+template<typename T>
+void gather_blocks(const T* src, const AxisStrides& view, T* dst, const std::vector<Eigen::Index>& idx) {
+  const Eigen::Index n = idx.size();
+  const Eigen::Index inner = view.inner();
+  const Eigen::Index runs = view.run_offsets.size();
+  const std::vector<Eigen::Index> order = sorted_order(idx);
+  const Eigen::Index work = view.outer_offsets.size() * n;
+  NDARRAY_OMP("omp parallel for schedule(static) if(work * inner > parallel_threshold)")
+  for (Eigen::Index w = 0; w < work; ++w) {
+    Eigen::Index o = w / n;
+    Eigen::Index j = order[w % n];
+    const T* s = src + view.outer_offsets[o] + idx[j] * view.axis_stride;
+    T* d = dst + inner * (j + n * o);
+    for (Eigen::Index r = 0; r < runs; ++r) std::copy_n(s + view.run_offsets[r], view.run, d + r * view.run);
+  }
+}
+
+// Scatter dense values into the view. Duplicate indices are grouped after sorting, so each
+// destination block is owned by exactly one iteration: accumulate sums the whole group,
+// otherwise the last occurrence wins
+template<typename T>
+void scatter_blocks(const T* src, T* dst, const AxisStrides& view, const std::vector<Eigen::Index>& idx, bool accumulate) {
+  const Eigen::Index n = idx.size();
+  const Eigen::Index inner = view.inner();
+  const Eigen::Index runs = view.run_offsets.size();
+  const std::vector<Eigen::Index> order = sorted_order(idx);
+  std::vector<Eigen::Index> groups;
+  for (Eigen::Index k = 0; k < n; ++k) {
+    if (k == 0 || idx[order[k]] != idx[order[k - 1]]) groups.push_back(k);
+  }
+  const Eigen::Index n_groups = groups.size();
+  groups.push_back(n);
+  const Eigen::Index work = view.outer_offsets.size() * n_groups;
+  NDARRAY_OMP("omp parallel for schedule(static) if(work * inner > parallel_threshold)")
+  for (Eigen::Index w = 0; w < work; ++w) {
+    Eigen::Index o = w / n_groups;
+    Eigen::Index g = w % n_groups;
+    T* target = dst + view.outer_offsets[o] + idx[order[groups[g]]] * view.axis_stride;
+    Eigen::Index first = accumulate ? groups[g] : groups[g + 1] - 1;
+    for (Eigen::Index k = first; k < groups[g + 1]; ++k) {
+      const T* source = src + inner * (order[k] + n * o);
+      for (Eigen::Index r = 0; r < runs; ++r) {
+        T* t = target + view.run_offsets[r];
+        const T* s = source + r * view.run;
+        if (accumulate) {
+          for (Eigen::Index i = 0; i < view.run; ++i) t[i] += s[i];
+        } else {
+          std::copy_n(s, view.run, t);
+        }
+      }
+    }
+  }
+}
+
+template<typename T, size_t M, size_t N>
+template<typename I, size_t J>
+Ndarray<T, M> Ndarray<T, M, N>::take(const Ndarray<I, 1, J>& indices_, int axis) const {
+  AxisLayout layout = axis_layout<M>(indices.extents, axis);
+  std::vector<Eigen::Index> idx = read_indices(indices_, layout.extent);
+  Eigen::array<Eigen::Index, M> res_dims = indices.extents;
+  res_dims[axis] = idx.size();
+  auto res = std::make_shared<Tensor<T, M>>(res_dims);
+  Eigen::array<Eigen::Index, M> strides;
+  Eigen::Index origin = view_strides(strides);
+  AxisStrides view = axis_strides<M>(strides, indices.extents, origin, axis);
+  gather_blocks(base_array->data(), view, res->data(), idx);
+  return Ndarray<T, M>(res);
+}
+
+template<typename T, size_t M, size_t N>
+template<typename I, size_t J, size_t K, size_t L>
+void Ndarray<T, M, N>::put(const Ndarray<I, 1, J>& indices_, const Ndarray<T, K, L>& values, int axis, bool accumulate) {
+  static_assert(M == K, "Values must have the same dimensionality as the target array");
+  AxisLayout layout = axis_layout<M>(indices.extents, axis);
+  std::vector<Eigen::Index> idx = read_indices(indices_, layout.extent);
+  Eigen::array<Eigen::Index, M> expected_dims = indices.extents;
+  expected_dims[axis] = idx.size();
+  if (!std::equal(expected_dims.begin(), expected_dims.end(), values.indices.extents.begin())) {
+    throw std::runtime_error("Values extents must match the array with the indexed axis replaced by the index count");
+  }
+  // Values that share storage with the target are copied first, the scatter would overwrite them
+  bool shares_storage = static_cast<const void*>(values.base_array.get()) == static_cast<const void*>(base_array.get());
+  Tensor<T, M> values_dense;
+  const T* src = values.base_array->data();
+  if (L != K || values.is_sliced || shares_storage) {
+    values_dense = values.get_array();
+    src = values_dense.data();
+  }
+  Eigen::array<Eigen::Index, M> strides;
+  Eigen::Index origin = view_strides(strides);
+  AxisStrides view = axis_strides<M>(strides, indices.extents, origin, axis);
+  scatter_blocks(src, base_array->data(), view, idx, accumulate);
+}
@@ -6,11 +6,23 @@
 #pragma GCC diagnostic pop
 
 #include <memory>
+#include <complex>
+#include <vector>
 #include <iomanip>
 
 using namespace Eigen;
 using namespace std;
 
+// Kernels are split across OpenMP threads only when built with -fopenmp and once they
+// touch more than parallel_threshold elements
+#ifdef _OPENMP
+#define NDARRAY_OMP(directive) _Pragma(directive)
+#else
+#define NDARRAY_OMP(directive)
+#endif
+
+constexpr Eigen::Index parallel_threshold = 32768;
+
 class R {
 public:
   long start, end;
@@ -24,6 +36,28 @@ public:
   }
 };
 
+enum class Boundary { Periodic, Clamped, Zero };
+
+// Coefficients along one axis; coefficient k is applied at offset k - origin (centered by default)
+template<typename T>
+class Stencil {
+public:
+  int axis;
+  std::vector<T> coefficients;
+  Boundary boundary;
+  long origin;
+  Stencil(int axis, const std::vector<T>& coefficients, Boundary boundary = Boundary::Periodic, long origin = -1)
+    : axis(axis), coefficients(coefficients), boundary(boundary),
+      origin(origin == -1 ? static_cast<long>(coefficients.size()) / 2 : origin) {
+    if (coefficients.empty()) {
+      throw std::invalid_argument("Stencil needs at least one coefficient");
+    }
+    if (this->origin < 0 || this->origin >= static_cast<long>(coefficients.size())) {
+      throw std::invalid_argument("Stencil origin must lie within its coefficients");
+    }
+  }
+};
+
 template<size_t M, size_t N>
 struct Indices {
     Eigen::array<Eigen::Index, M> offsets;
@@ -36,6 +70,8 @@ template<typename T, size_t M, size_t N=M>
 class Ndarray {
 public:
   using SharedTensor = std::shared_ptr<Tensor<T, N>>;
+  using RealScalar = typename Eigen::NumTraits<T>::Real;
+  using ComplexScalar = std::complex<RealScalar>;
   SharedTensor base_array;
   Indices<M, N> indices;
   bool is_sliced = false;
@@ -73,6 +109,9 @@ public:
     return chipped_view.slice(indices.offsets, indices.extents);
   }
 
+  // Base-array strides of the view's dims; returns the base offset of the view's first element
+  Eigen::Index view_strides(Eigen::array<Eigen::Index, M>& strides) const;
+
   int dimension(int dim) const {
     return indices.extents[dim];
   }
@@ -102,6 +141,29 @@ public:
   template<typename... Slices>
   auto slice(const Slices&... slices);
 
+  template<typename I, size_t J>
+  Ndarray<T, M> take(const Ndarray<I, 1, J>& indices_, int axis = 0) const;
+
+  template<typename I, size_t J, size_t K, size_t L>
+  void put(const Ndarray<I, 1, J>& indices_, const Ndarray<T, K, L>& values, int axis = 0, bool accumulate = false);
+
+  // Transforms over the given axes (all axes if empty); out-parameter variants reuse the output buffer
+  Ndarray<ComplexScalar, M> fft(const std::vector<int>& axes = {}) const;
+  Ndarray<ComplexScalar, M> ifft(const std::vector<int>& axes = {}) const;
+  Ndarray<ComplexScalar, M> rfft(const std::vector<int>& axes = {}) const;
+  Ndarray<RealScalar, M> irfft(const std::vector<int>& axes = {}, Eigen::Index n = -1) const;
+  void fft(Ndarray<ComplexScalar, M>& out, const std::vector<int>& axes = {}) const;
+  void ifft(Ndarray<ComplexScalar, M>& out, const std::vector<int>& axes = {}) const;
+  void rfft(Ndarray<ComplexScalar, M>& out, const std::vector<int>& axes = {}) const;
+  // Only the scratch overload of irfft is allocation-free; the other allocates a complex copy per call
+  void irfft(Ndarray<RealScalar, M>& out, const std::vector<int>& axes = {}, Eigen::Index n = -1) const;
+  void irfft(Ndarray<RealScalar, M>& out, Ndarray<ComplexScalar, M>& scratch,
+             const std::vector<int>& axes = {}, Eigen::Index n = -1) const;
+
+  // Sum of all stencils evaluated in a single pass; accumulate adds onto the contents of out
+  Ndarray<T, M> stencil(const std::vector<Stencil<T>>& stencils) const;
+  void stencil(Ndarray<T, M>& out, const std::vector<Stencil<T>>& stencils, bool accumulate = false) const;
+
 
   template<size_t K, size_t J>
   typename std::enable_if<M == 1 && K == 1 && N == M && J == K, T>::type
@@ -193,7 +255,21 @@ private:
   }
 };
 
+// Make out a full array with the given extents, reallocating only when they differ
+template<typename S, size_t M>
+void ensure_extents(Ndarray<S, M>& out, const Eigen::array<Eigen::Index, M>& dims) {
+  if (out.is_sliced) {
+    throw std::runtime_error("Output array must not be a slice");
+  }
+  if (!std::equal(dims.begin(), dims.end(), out.indices.extents.begin())) {
+    out = Ndarray<S, M>(std::make_shared<Tensor<S, M>>(dims));
+  }
+}
+
 #include "compare.h"
 #include "print.h"
 #include "slice.h"
+#include "indexing.h"
+#include "fft.h"
+#include "stencil.h"
 #include "algebra.h"
\ No newline at end of file
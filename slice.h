@@ -57,4 +57,32 @@ template<typename T, size_t M, size_t N>
 template<typename TensorType>
 auto Ndarray<T, M, N>::chip_tensor(TensorType &tensor, const std::array<std::pair<int, int>, N-M> &chip_indices) const {
   return chip_tensor_recursive<TensorType, N-M>(tensor, chip_indices);
-}
\ No newline at end of file
+}
+
+// Chips are applied in the same order as chip_tensor: each (dim, row) refers to the dims left
+// after the chips before it, adds row * stride to the origin and drops that dim
+template<typename T, size_t M, size_t N>
+Eigen::Index Ndarray<T, M, N>::view_strides(Eigen::array<Eigen::Index, M>& strides) const {
+  std::vector<Eigen::Index> dims(N);
+  std::vector<Eigen::Index> base_strides(N);
+  for (size_t i = 0; i < N; ++i) {
+    dims[i] = base_array->dimension(i);
+    base_strides[i] = i == 0 ? 1 : base_strides[i - 1] * dims[i - 1];
+  }
+  Eigen::Index origin = 0;
+  for (size_t c = N - M; c-- > 0;) {
+    int dim = indices.chip_indices[c].first;
+    int row = indices.chip_indices[c].second;
+    if (dim < 0 || dim >= static_cast<int>(dims.size()) || row < 0 || row >= dims[dim]) {
+      throw std::out_of_range("Chip index out of range");
+    }
+    origin += row * base_strides[dim];
+    dims.erase(dims.begin() + dim);
+    base_strides.erase(base_strides.begin() + dim);
+  }
+  for (size_t i = 0; i < M; ++i) {
+    strides[i] = base_strides[i];
+    origin += indices.offsets[i] * strides[i];
+  }
+  return origin;
+}
@@ -0,0 +1,165 @@
+#include <iostream>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+#include <Eigen/Dense>
+
+#include <memory>
+#include <algorithm>
+#include <vector>
+
+// Position read for index i along an axis of extent n, or -1 when it contributes nothing
+inline Eigen::Index boundary_index(Eigen::Index i, Eigen::Index n, Boundary boundary) {
+  if (i >= 0 && i < n) return i;
+  switch (boundary) {
+    case Boundary::Periodic:
+      return ((i % n) + n) % n;
+    case Boundary::Clamped:
+      return i < 0 ? 0 : n - 1;
+    default:
+      return -1;
+  }
+}
+
+template<typename T>
+struct StencilTerm {
+  int axis;
+  Eigen::Index offset;
+  T coefficient;
+  Boundary boundary;
+};
+
+// Sweep the array once in tiles of an axis-0 chunk by an axis-1 block. Each tile is streamed
+// along axis 2, so the few planes an axis-2 term reads stay in cache while the tile moves
+// through them, and every term is a vectorized multiply-add of a source segment. The source is
+// read through its own strides, so slices and chips are swept in place in their base array
+template<typename T, size_t M>
+void stencil_sweep(const T* src, const Eigen::array<Eigen::Index, M>& src_strides, T* dst,
+                   const Eigen::array<Eigen::Index, M>& dims, const std::vector<StencilTerm<T>>& terms, bool accumulate) {
+  using Segment = Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>>;
+  using ConstSegment = Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>>;
+  using StridedSegment = Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>, 0, Eigen::InnerStride<>>;
+  constexpr Eigen::Index tile_elements = 4096;
+  Eigen::array<Eigen::Index, M> strides;
+  strides[0] = 1;
+  for (size_t i = 1; i < M; ++i) strides[i] = strides[i - 1] * dims[i - 1];
+  const Eigen::Index s0 = src_strides[0];
+  const Eigen::Index n0 = dims[0];
+  Eigen::Index n1 = 1;
+  Eigen::Index n2 = 1;
+  if constexpr (M > 1) n1 = dims[1];
+  if constexpr (M > 2) n2 = dims[2];
+  Eigen::Index outer = 1;
+  for (size_t i = 3; i < M; ++i) outer *= dims[i];
+  if (n0 * n1 * n2 * outer == 0) return;
+
+  const Eigen::Index chunk = std::min<Eigen::Index>(n0, 512);
+  const Eigen::Index chunks = (n0 + chunk - 1) / chunk;
+  const Eigen::Index block = std::clamp<Eigen::Index>(tile_elements / chunk, 1, n1);
+  const Eigen::Index blocks = (n1 + block - 1) / block;
+  const Eigen::Index work = outer * blocks * chunks;
+
+  NDARRAY_OMP("omp parallel for schedule(static) if(n0 * n1 * n2 * outer > parallel_threshold)")
+  for (Eigen::Index w = 0; w < work; ++w) {
+    Eigen::Index o = w / (blocks * chunks);
+    Eigen::Index j0 = (w / chunks % blocks) * block;
+    Eigen::Index j1 = std::min(j0 + block, n1);
+    Eigen::Index i0 = (w % chunks) * chunk;
+    Eigen::Index len = std::min(chunk, n0 - i0);
+    Eigen::array<Eigen::Index, M> coords;
+    coords[0] = i0;
+    Eigen::Index origin = i0;
+    Eigen::Index src_origin = i0 * s0;
+    Eigen::Index rest = o;
+    for (size_t i = 3; i < M; ++i) {
+      coords[i] = rest % dims[i];
+      rest /= dims[i];
+      origin += coords[i] * strides[i];
+      src_origin += coords[i] * src_strides[i];
+    }
+    for (Eigen::Index k = 0; k < n2; ++k) {
+      for (Eigen::Index j = j0; j < j1; ++j) {
+        Eigen::Index line = origin;
+        Eigen::Index src_line = src_origin;
+        if constexpr (M > 1) {
+          coords[1] = j;
+          line += j * strides[1];
+          src_line += j * src_strides[1];
+        }
+        if constexpr (M > 2) {
+          coords[2] = k;
+          line += k * strides[2];
+          src_line += k * src_strides[2];
+        }
+        Segment out(dst + line, len);
+        if (!accumulate) out.setZero();
+        // Adds coefficient * source[0, count) onto out[start, start + count)
+        auto add = [&](Eigen::Index start, Eigen::Index count, T coefficient, const T* source) {
+          if (s0 == 1) {
+            out.segment(start, count) += coefficient * ConstSegment(source, count);
+          } else {
+            out.segment(start, count) += coefficient * StridedSegment(source, count, Eigen::InnerStride<>(s0));
+          }
+        };
+        for (const auto& term : terms) {
+          if (term.axis == 0) {
+            // Interior part reads a shifted segment, the rest goes through the boundary
+            Eigen::Index lo = std::clamp<Eigen::Index>(-term.offset - i0, 0, len);
+            Eigen::Index hi = std::clamp<Eigen::Index>(n0 - term.offset - i0, lo, len);
+            if (hi > lo) {
+              add(lo, hi - lo, term.coefficient, src + src_line + (lo + term.offset) * s0);
+            }
+            auto edge = [&](Eigen::Index i) {
+              Eigen::Index q = boundary_index(i0 + i + term.offset, n0, term.boundary);
+              if (q >= 0) out(i) += term.coefficient * src[src_line + (q - i0) * s0];
+            };
+            for (Eigen::Index i = 0; i < lo; ++i) edge(i);
+            for (Eigen::Index i = hi; i < len; ++i) edge(i);
+          } else {
+            Eigen::Index c = coords[term.axis];
+            Eigen::Index q = boundary_index(c + term.offset, dims[term.axis], term.boundary);
+            if (q < 0) continue;
+            add(0, len, term.coefficient, src + src_line + (q - c) * src_strides[term.axis]);
+          }
+        }
+      }
+    }
+  }
+}
+
+template<typename T, size_t M, size_t N>
+void Ndarray<T, M, N>::stencil(Ndarray<T, M>& out, const std::vector<Stencil<T>>& stencils, bool accumulate) const {
+  if constexpr (N == M) {
+    if (out.base_array == base_array) {
+      throw std::invalid_argument("Stencil output must not share storage with its input");
+    }
+  }
+  std::vector<StencilTerm<T>> terms;
+  for (const auto& s : stencils) {
+    if (s.axis < 0 || s.axis >= static_cast<int>(M)) {
+      throw std::invalid_argument("Axis out of range");
+    }
+    for (size_t k = 0; k < s.coefficients.size(); ++k) {
+      if (s.coefficients[k] != T(0)) {
+        terms.push_back({s.axis, static_cast<Eigen::Index>(k) - s.origin, s.coefficients[k], s.boundary});
+      }
+    }
+  }
+  if (accumulate) {
+    if (out.is_sliced || !std::equal(indices.extents.begin(), indices.extents.end(), out.indices.extents.begin())) {
+      throw std::runtime_error("Accumulating stencil output must be a full array with the input extents");
+    }
+  } else {
+    ensure_extents(out, indices.extents);
+  }
+
+  Eigen::array<Eigen::Index, M> src_strides;
+  Eigen::Index origin = view_strides(src_strides);
+  stencil_sweep<T, M>(base_array->data() + origin, src_strides, out.base_array->data(), indices.extents, terms, accumulate);
+}
+
+template<typename T, size_t M, size_t N>
+Ndarray<T, M> Ndarray<T, M, N>::stencil(const std::vector<Stencil<T>>& stencils) const {
+  Ndarray<T, M> res(std::make_shared<Tensor<T, M>>(indices.extents));
+  stencil(res, stencils);
+  return res;
+}
@@ -215,6 +215,232 @@ TEST(NdarrayTest, MatrixMultiplicationOnSlice) {
   EXPECT_TRUE(result.allclose(expected));
 }
 
+TEST(NdarrayTest, TakeAlongAxis) {
+  Ndarray<double, 2> mat({3, 3});
+  mat.base_array->setValues({{1, 2, 3},
+                             {4, 5, 6},
+                             {7, 8, 9}});
+  Ndarray<long, 1> idx({3});
+  idx.base_array->setValues({2, 0, 2});
+
+  Ndarray<double, 2> rows = mat.take(idx, 0);
+  Ndarray<double, 2> expected_rows({3, 3});
+  expected_rows.base_array->setValues({{7, 8, 9},
+                                       {1, 2, 3},
+                                       {7, 8, 9}});
+  EXPECT_TRUE(rows.allclose(expected_rows));
+
+  Ndarray<double, 2> cols = mat.take(idx, 1);
+  Ndarray<double, 2> expected_cols({3, 3});
+  expected_cols.base_array->setValues({{3, 1, 3},
+                                       {6, 4, 6},
+                                       {9, 7, 9}});
+  EXPECT_TRUE(cols.allclose(expected_cols));
+
+  idx(1) = 3;
+  EXPECT_THROW(mat.take(idx, 0), std::out_of_range);
+}
+
+TEST(NdarrayTest, PutAlongAxis) {
+  Ndarray<double, 2> mat({3, 2});
+  Ndarray<long, 1> idx({3});
+  idx.base_array->setValues({2, 0, 2});
+  Ndarray<double, 2> values({3, 2});
+  values.base_array->setValues({{1, 2},
+                                {3, 4},
+                                {5, 6}});
+
+  mat.put(idx, values, 0);
+  Ndarray<double, 2> expected({3, 2});
+  expected.base_array->setValues({{3, 4},
+                                  {0, 0},
+                                  {5, 6}});
+  EXPECT_TRUE(mat.allclose(expected));
+
+  mat.put(idx, values, 0, true);
+  expected.base_array->setValues({{ 6,  8},
+                                  { 0,  0},
+                                  {11, 14}});
+  EXPECT_TRUE(mat.allclose(expected));
+
+  Ndarray<long, 1> swap({3});
+  swap.base_array->setValues({2, 1, 0});
+  mat.put(swap, mat, 0);
+  expected.base_array->setValues({{11, 14},
+                                  { 0,  0},
+                                  { 6,  8}});
+  EXPECT_TRUE(mat.allclose(expected));
+}
+
+TEST(NdarrayTest, TakePutOnSlice) {
+  Ndarray<double, 3> tensor({3, 3, 3});
+  tensor.base_array->setValues({
+    {{ 0,  1,  2}, { 3,  4,  5}, { 6,  7,  8}},
+    {{ 9, 10, 11}, {12, 13, 14}, {15, 16, 17}},
+    {{18, 19, 20}, {21, 22, 23}, {24, 25, 26}}
+  });
+  Ndarray<double, 2, 3> mat = tensor.slice(R(0,3), R(1,3), 0);
+  Ndarray<long, 1> idx({2});
+  idx.base_array->setValues({2, 0});
+
+  Ndarray<double, 2> result = mat.take(idx, 0);
+  Ndarray<double, 2> expected({2, 2});
+  expected.base_array->setValues({{21, 24},
+                                  { 3,  6}});
+  EXPECT_TRUE(result.allclose(expected));
+
+  mat.put(idx, result * 2.0, 0, true);
+  EXPECT_DOUBLE_EQ(tensor(2, 1, 0), 63);
+  EXPECT_DOUBLE_EQ(tensor(0, 2, 0), 18);
+  EXPECT_DOUBLE_EQ(tensor(1, 1, 0), 12);
+  EXPECT_DOUBLE_EQ(tensor(2, 1, 1), 22);
+}
+
+TEST(NdarrayTest, TakePutOnRangeSlice) {
+  Ndarray<double, 3> tensor({3, 3, 2});
+  tensor.base_array->setValues({
+    {{ 0,  1}, { 2,  3}, { 4,  5}},
+    {{ 6,  7}, { 8,  9}, {10, 11}},
+    {{12, 13}, {14, 15}, {16, 17}}
+  });
+  Ndarray<double, 3> view = tensor.slice(R(1,3), R(0,2), R(0,2));
+  Ndarray<long, 1> idx({2});
+  idx.base_array->setValues({1, 1});
+
+  Ndarray<double, 3> result = view.take(idx, 1);
+  EXPECT_EQ(result.dimension(1), 2);
+  EXPECT_DOUBLE_EQ(result(0, 0, 0), 8);
+  EXPECT_DOUBLE_EQ(result(1, 1, 1), 15);
+
+  view.put(idx, result, 1, true);
+  EXPECT_DOUBLE_EQ(tensor(1, 1, 0), 24);
+  EXPECT_DOUBLE_EQ(tensor(2, 1, 1), 45);
+  EXPECT_DOUBLE_EQ(tensor(0, 1, 0), 2);
+  EXPECT_DOUBLE_EQ(tensor(1, 2, 0), 10);
+}
+
+TEST(NdarrayTest, FFTRoundTrip) {
+  Ndarray<double, 2> mat({4, 3});
+  mat.base_array->setValues({{1, 2, 3},
+                             {4, 5, 6},
+                             {7, 8, 9},
+                             {0, 1, 0}});
+
+  Ndarray<std::complex<double>, 2> spectrum = mat.fft({0});
+  // Column sums in the zero bin, alternating sums in the Nyquist bin
+  EXPECT_NEAR(spectrum(0, 0).real(), 12, 1e-12);
+  EXPECT_NEAR(spectrum(2, 1).real(), 4, 1e-12);
+  EXPECT_NEAR(spectrum(1, 2).real(), -6, 1e-12);
+  EXPECT_NEAR(spectrum(1, 2).imag(), -6, 1e-12);
+
+  Ndarray<std::complex<double>, 2> full = mat.fft();
+  Ndarray<std::complex<double>, 2> back({4, 3});
+  full.ifft(back);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_NEAR(back(i, j).real(), mat(i, j), 1e-12);
+      EXPECT_NEAR(back(i, j).imag(), 0, 1e-12);
+    }
+  }
+}
+
+TEST(NdarrayTest, RealFFTRoundTrip) {
+  Ndarray<double, 3> tensor({3, 3, 3});
+  tensor.base_array->setValues({
+    {{ 0,  1,  2}, { 3,  4,  5}, { 6,  7,  8}},
+    {{ 9, 10, 11}, {12, 13, 14}, {15, 16, 17}},
+    {{18, 19, 20}, {21, 22, 23}, {24, 25, 26}}
+  });
+  Ndarray<double, 2, 3> mat = tensor.slice(R(0,3), R(0,3), 1);
+
+  Ndarray<std::complex<double>, 2> half = mat.rfft();
+  EXPECT_EQ(half.dimension(0), 3);
+  EXPECT_EQ(half.dimension(1), 2);
+  // [[1, 4, 7], [10, 13, 16], [19, 22, 25]]: column sums 30, 39, 48 feed bin (0, 1)
+  EXPECT_NEAR(half(0, 0).real(), 117, 1e-12);
+  EXPECT_NEAR(half(0, 1).real(), -13.5, 1e-12);
+  EXPECT_NEAR(half(0, 1).imag(), 4.5 * std::sqrt(3.0), 1e-12);
+  Ndarray<std::complex<double>, 2> full = mat.fft();
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      EXPECT_NEAR(std::abs(half(i, j) - full(i, j)), 0, 1e-12);
+    }
+  }
+
+  Ndarray<double, 2> back = half.irfft({}, 3);
+  EXPECT_TRUE(back.allclose(mat, 1e-12));
+  EXPECT_THROW(half.irfft({}, 4), std::invalid_argument);
+
+  Ndarray<double, 2> reused({3, 3});
+  half.irfft(reused, half, {}, 3);
+  EXPECT_TRUE(reused.allclose(mat, 1e-12));
+}
+
+TEST(NdarrayTest, FFTOnEmptyArray) {
+  Ndarray<double, 2> empty({0, 4});
+  Ndarray<std::complex<double>, 2> spectrum = empty.fft({1});
+  EXPECT_EQ(spectrum.dimension(0), 0);
+  EXPECT_EQ(spectrum.dimension(1), 4);
+  Ndarray<std::complex<double>, 2> half = empty.rfft({1});
+  EXPECT_EQ(half.dimension(1), 3);
+  EXPECT_EQ(half.irfft({1}).dimension(1), 4);
+  EXPECT_EQ(empty.fft({0}).dimension(0), 0);
+  EXPECT_THROW(empty.rfft({0}), std::invalid_argument);
+}
+
+TEST(NdarrayTest, StencilBoundaries) {
+  Ndarray<double, 1> vec({5});
+  vec.base_array->setValues({1, 2, 4, 7, 11});
+
+  Ndarray<double, 1> periodic = vec.stencil({Stencil<double>(0, {-0.5, 0, 0.5})});
+  Ndarray<double, 1> expected({5});
+  expected.base_array->setValues({-4.5, 1.5, 2.5, 3.5, -3});
+  EXPECT_TRUE(periodic.allclose(expected));
+
+  Ndarray<double, 1> clamped = vec.stencil({Stencil<double>(0, {-0.5, 0, 0.5}, Boundary::Clamped)});
+  expected.base_array->setValues({0.5, 1.5, 2.5, 3.5, 2});
+  EXPECT_TRUE(clamped.allclose(expected));
+
+  Ndarray<double, 1> forward = vec.stencil({Stencil<double>(0, {-1, 1}, Boundary::Zero, 0)});
+  expected.base_array->setValues({1, 2, 3, 4, -11});
+  EXPECT_TRUE(forward.allclose(expected));
+
+  EXPECT_THROW(Stencil<double>(0, {-1, 1}, Boundary::Zero, -2), std::invalid_argument);
+  Ndarray<double, 2> empty({0, 4});
+  EXPECT_EQ(empty.stencil({Stencil<double>(1, {1, -1})}).dimension(0), 0);
+}
+
+TEST(NdarrayTest, StencilLaplacianOnSlice) {
+  Ndarray<double, 3> tensor({3, 3, 3});
+  tensor.base_array->setValues({
+    {{ 0,  1,  2}, { 3,  4,  5}, { 6,  7,  8}},
+    {{ 9, 10, 11}, {12, 13, 14}, {15, 16, 17}},
+    {{18, 19, 20}, {21, 22, 23}, {24, 25, 26}}
+  });
+  Ndarray<double, 2, 3> mat = tensor.slice(R(0,3), R(0,3), 1);
+  Ndarray<double, 2> laplacian = mat.stencil({Stencil<double>(0, {1, -2, 1}, Boundary::Zero),
+                                              Stencil<double>(1, {1, -2, 1}, Boundary::Zero)});
+  // [[1, 4, 7], [10, 13, 16], [19, 22, 25]] with zeros outside
+  Ndarray<double, 2> expected({3, 3});
+  expected.base_array->setValues({{ 10,   5,  -8},
+                                  { -7,   0, -19},
+                                  {-44, -31, -62}});
+  EXPECT_TRUE(laplacian.allclose(expected));
+
+  Ndarray<double, 2> rows = tensor.slice(R(1,3), R(0,3), 1).stencil({Stencil<double>(0, {-1, 1}, Boundary::Zero, 0)});
+  Ndarray<double, 2> expected_rows({2, 3});
+  expected_rows.base_array->setValues({{  9,   9,   9},
+                                       {-19, -22, -25}});
+  EXPECT_TRUE(rows.allclose(expected_rows));
+
+  laplacian.set_constant(1);
+  mat.stencil(laplacian, {Stencil<double>(1, {-1, 1}, Boundary::Clamped, 0)}, true);
+  expected.base_array->setValues({{4, 4, 1},
+                                  {4, 4, 1},
+                                  {4, 4, 1}});
+  EXPECT_TRUE(laplacian.allclose(expected));
+}
+
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);